@@ -21,6 +21,23 @@ typedef struct _observer {
 	uint16_t dist;
 } observer_t;
 
+typedef struct _sec_flow {
+	uint16_t prod;
+	uint16_t cons;
+	bool     valid;		/* false if free */
+	uint16_t interval;	/* Current sampling interval */
+	uint16_t size;		/* Size of the last message */
+	uint32_t latency;	/* Average latency */
+
+	/* Run of messages not yet sent to the observer */
+	uint16_t count;
+	uint16_t hops;
+	uint32_t timestamp;	/* Of the last message */
+	uint32_t last;		/* Tick the last message arrived */
+	uint32_t lat_sum;
+	uint32_t size_sum;
+} sec_flow_t;
+
 /**
  * @brief Initializes the monitoring structures
  */
@@ -47,6 +64,11 @@ bool llm_has_monitor(int mon_id);
 /**
  * @brief Monitor real-time constraints
  * 
+ * @details Feeds the slack table on every call and reports to the QoS
+ * observer, if any, each MON_INTERVAL_QOS. The scheduler should call it
+ * whenever it computes the slack of a real-time task, even without a QoS
+ * observer.
+ * 
  * @param last_monitored Pointer to last monitored time
  * @param id ID of the monitored task
  * @param slack_time Slack time of the monitored task
@@ -59,6 +81,13 @@ void llm_rt(unsigned *last_monitored, int id, unsigned slack_time, unsigned rema
 /**
  * @bried Monitor security contraints
  * 
+ * @details Sampled according to MON_SEC_SAMPLING. Unsampled messages are
+ * accumulated in a run that is sent as a single record carrying the mean
+ * latency and size of the run and its number of messages as weight. A run
+ * is also sent when its flow is evicted from the flow table, when its
+ * consumer leaves the PE (llm_sec_flush) and when no message of the flow
+ * arrived for MON_SEC_MAX_AGE ticks (checked on every llm_sec and llm_rt).
+ * 
  * @param timestamp Timestamp of received message
  * @param size      Size of received message (in flits)
  * @param src       Source address of received message
@@ -69,4 +98,13 @@ void llm_rt(unsigned *last_monitored, int id, unsigned slack_time, unsigned rema
  */
 void llm_sec(unsigned timestamp, unsigned size, int src, int dst, int prod, int cons, unsigned now);
 
+/**
+ * @brief Sends the pending SEC runs of the flows consumed by a task
+ * 
+ * @details Called when the task terminates or migrates
+ * 
+ * @param task ID of the consumer task
+ */
+void llm_sec_flush(int task);
+
 void llm_vol(unsigned size, int src, int dst);
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**
+ * MAestro
+ * @file slack.h
+ *
+ * @date October 2026
+ *
+ * @brief Least-slack preemption hint for real-time tasks
+ *
+ * @details This is not a scheduling policy: it only decides if releasing a
+ * task should call the scheduler now, when the released real-time task has
+ * less slack than the running one. The choice of the next task stays with
+ * the scheduler. The slack table is fed by llm_rt, which the scheduler calls
+ * with the slack it computes for each real-time task.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifndef SLACK_PREEMPT
+#define SLACK_PREEMPT false	/* Default policy of the PE */
+#endif
+
+/**
+ * @brief Clears the slack table
+ *
+ * @details Optional: the table is statically initialized empty
+ */
+void slack_init();
+
+/**
+ * @brief Enables or disables the least-slack preemption in this PE
+ *
+ * @param enabled True to enable
+ */
+void slack_set_enabled(bool enabled);
+
+/**
+ * @brief Updates the real-time state of a task
+ *
+ * @details Counts a deadline miss when the slack of a task with remaining
+ * execution time reaches zero
+ *
+ * @param id ID of the task
+ * @param slack_time Slack time of the task
+ * @param remaining_exec_time Remaining execution time of the task
+ */
+void slack_update(int id, unsigned slack_time, unsigned remaining_exec_time);
+
+/**
+ * @brief Removes a task from the slack table
+ *
+ * @details Logs the deadline misses of the task, if any. Entries of tasks no
+ * longer in this PE (terminated or migrated) are also reclaimed, and logged,
+ * when the table is full.
+ *
+ * @param id ID of the task
+ */
+void slack_remove(int id);
+
+/**
+ * @brief Checks if a released task should preempt the running one
+ *
+ * @param id ID of the released task
+ * @return true If the released task is real-time and has less slack
+ */
+bool slack_should_preempt(int id);
@@ -20,18 +20,73 @@
 #include <broadcast.h>
 #include <kernel_pipe.h>
 #include <mpipe.h>
+#include <slack.h>
 
 #include <memphis.h>
 #include <memphis/monitor.h>
 #include <memphis/services.h>
 #include <memphis/messaging.h>
 
+#define LLM_SEC_FLOWS 16
+
 observer_t _observers[MON_MAX];
+sec_flow_t _sec_flows[LLM_SEC_FLOWS];
+
+/**
+ * @brief Gets the flow of a SEC message, evicting the flow in its slot
+ * 
+ * @param prod Producer task
+ * @param cons Consumer task
+ * 
+ * @return Pointer to the flow, not valid if it is new
+ */
+sec_flow_t *_llm_sec_flow(int prod, int cons);
+
+/**
+ * @brief Sends the pending runs that received no message for MON_SEC_MAX_AGE
+ * 
+ * @param now Current tick
+ */
+void _llm_sec_flush_stale(unsigned now);
+
+/**
+ * @brief Adds a message to the pending run of a flow
+ * 
+ * @param flow Pointer to the flow
+ * @param timestamp Timestamp of the message
+ * @param latency Latency of the message
+ * @param hops Hops of the message
+ * @param size Size of the message
+ */
+void _llm_sec_accumulate(sec_flow_t *flow, unsigned timestamp, unsigned latency, unsigned hops, unsigned size);
+
+/**
+ * @brief Sends the pending run of a flow as a single weighted record
+ * 
+ * @param flow Pointer to the flow
+ */
+void _llm_sec_flush(sec_flow_t *flow);
+
+/**
+ * @brief Sends a SEC record to the observer
+ * 
+ * @param prod Producer task
+ * @param cons Consumer task
+ * @param timestamp Timestamp of the (last) message
+ * @param latency Latency of the message or mean latency of the run
+ * @param hops Hops of the message
+ * @param size Size of the message or mean size of the run
+ * @param weight Number of messages represented
+ */
+void _llm_sec_send(int prod, int cons, unsigned timestamp, unsigned latency, unsigned hops, unsigned size, unsigned weight);
 
 void llm_init()
 {
 	for(int i = 0; i < MON_MAX; i++)
 		_observers[i].addr = -1;
+
+	for(int i = 0; i < LLM_SEC_FLOWS; i++)
+		_sec_flows[i].valid = false;
 }
 
 void llm_set_observer(enum MONITOR_TYPE type, int task, int addr)
@@ -57,9 +112,16 @@ bool llm_has_monitor(int mon_id)
 
 void llm_rt(unsigned *last_monitored, int id, unsigned slack_time, unsigned remaining_exec_time)
 {
+	/* Local preemption uses every update, the observer only each interval */
+	slack_update(id, slack_time, remaining_exec_time);
+
 	unsigned now = MMR_RTC_MTIME;
 
-	if (now - (*last_monitored) < MON_INTERVAL_QOS)
+	/* Periodic point for the runs of flows that stopped sending */
+	if (MON_SEC_SAMPLING != MON_SEC_FULL && llm_has_monitor(MON_SEC))
+		_llm_sec_flush_stale(now);
+
+	if (!llm_has_monitor(MON_QOS) || now - (*last_monitored) < MON_INTERVAL_QOS)
 		return;
 
 	memphis_qos_monitor_t monitor;
@@ -78,17 +140,81 @@ void llm_sec(unsigned timestamp, unsigned size, int src, int dst, int prod, int
 	const unsigned dst_x = (dst >> 8) & 0xFF;
 	const unsigned dst_y = (dst & 0xFF);
 
-	memphis_sec_monitor_t monitor;
-	monitor.prod      = prod;
-	monitor.cons      = cons;
-	monitor.service   = SEC_MONITOR;
-	monitor.app       = (prod >> 8) & 0xFF;
-	monitor.timestamp = timestamp;
-	monitor.latency   = (now - timestamp);
-	monitor.hops      = abs(src_x - dst_x) + abs(src_y - dst_y);
-	monitor.size      = size;
+	const unsigned latency = now - timestamp;
+	const unsigned hops    = abs(src_x - dst_x) + abs(src_y - dst_y);
 
-	mpipe_write(&monitor, sizeof(memphis_sec_monitor_t), _observers[MON_SEC].addr);
+	if (MON_SEC_SAMPLING == MON_SEC_FULL) {
+		_llm_sec_send(prod, cons, timestamp, latency, hops, size, 1);
+		return;
+	}
+
+	const unsigned tick = MMR_RTC_MTIME;
+	_llm_sec_flush_stale(tick);
+
+	sec_flow_t *flow = _llm_sec_flow(prod, cons);
+	flow->last = tick;
+	if (!flow->valid) {
+		/* New flow: always sample its first message */
+		flow->prod     = prod;
+		flow->cons     = cons;
+		flow->valid    = true;
+		flow->interval = 1;
+		flow->size     = size;
+		flow->latency  = latency;
+		flow->count    = 0;
+		_llm_sec_send(prod, cons, timestamp, latency, hops, size, 1);
+		return;
+	}
+
+	/* Route changed (migration): the run would mix two paths */
+	if (flow->count != 0 && flow->hops != hops)
+		_llm_sec_flush(flow);
+
+	if (MON_SEC_SAMPLING == MON_SEC_FIXED) {
+		_llm_sec_accumulate(flow, timestamp, latency, hops, size);
+		if (flow->count >= MON_SEC_RATE)
+			_llm_sec_flush(flow);
+
+		return;
+	}
+
+	/* Adaptive: every message is checked, deviations are always sampled */
+	unsigned avg = flow->latency;
+	unsigned dev = (latency > avg) ? (latency - avg) : (avg - latency);
+	bool steady = (size == flow->size && dev <= (avg >> 2));
+
+	flow->latency = avg - (avg >> 3) + (latency >> 3);
+	flow->size    = size;
+
+	if (!steady) {
+		/* Close the steady run before reporting the deviation on its own */
+		_llm_sec_flush(flow);
+		_llm_sec_send(prod, cons, timestamp, latency, hops, size, 1);
+		flow->interval = 1;
+		return;
+	}
+
+	_llm_sec_accumulate(flow, timestamp, latency, hops, size);
+	if (flow->count < flow->interval)
+		return;
+
+	_llm_sec_flush(flow);
+	if (flow->interval < MON_SEC_RATE) {
+		flow->interval <<= 1;
+		if (flow->interval > MON_SEC_RATE)
+			flow->interval = MON_SEC_RATE;
+	}
+}
+
+void llm_sec_flush(int task)
+{
+	for (int i = 0; i < LLM_SEC_FLOWS; i++) {
+		sec_flow_t *flow = &_sec_flows[i];
+		if (flow->valid && flow->cons == (uint16_t)task) {
+			_llm_sec_flush(flow);
+			flow->valid = false;
+		}
+	}
 }
 
 void llm_vol(unsigned size, int src, int dst)
@@ -106,3 +232,78 @@ void llm_vol(unsigned size, int src, int dst)
 
 	mpipe_write(&monitor, sizeof(memphis_vol_monitor_t), _observers[MON_VOL].addr);
 }
+
+sec_flow_t *_llm_sec_flow(int prod, int cons)
+{
+	const unsigned p = prod & 0xFFFF;
+	const unsigned c = cons & 0xFFFF;
+	sec_flow_t *flow = &_sec_flows[(p ^ (c << 2) ^ (c >> 8)) % LLM_SEC_FLOWS];
+	if (flow->valid && flow->prod == (uint16_t)prod && flow->cons == (uint16_t)cons)
+		return flow;
+
+	/* Collision: report the run of the evicted flow before reusing its slot */
+	if (flow->valid)
+		_llm_sec_flush(flow);
+
+	flow->valid = false;
+	return flow;
+}
+
+void _llm_sec_flush_stale(unsigned now)
+{
+	for (int i = 0; i < LLM_SEC_FLOWS; i++) {
+		sec_flow_t *flow = &_sec_flows[i];
+		if (flow->valid && flow->count != 0 && now - flow->last >= MON_SEC_MAX_AGE)
+			_llm_sec_flush(flow);
+	}
+}
+
+void _llm_sec_accumulate(sec_flow_t *flow, unsigned timestamp, unsigned latency, unsigned hops, unsigned size)
+{
+	if (flow->count == 0) {
+		flow->lat_sum  = 0;
+		flow->size_sum = 0;
+	}
+
+	flow->count++;
+	flow->hops       = hops;
+	flow->timestamp  = timestamp;
+	flow->lat_sum   += latency;
+	flow->size_sum  += size;
+}
+
+void _llm_sec_flush(sec_flow_t *flow)
+{
+	if (flow->count == 0)
+		return;
+
+	const unsigned half = flow->count >> 1;
+	_llm_sec_send(
+		flow->prod, 
+		flow->cons, 
+		flow->timestamp, 
+		(flow->lat_sum + half) / flow->count, 
+		flow->hops, 
+		(flow->size_sum + half) / flow->count, 
+		flow->count
+	);
+
+	flow->count = 0;
+}
+
+void _llm_sec_send(int prod, int cons, unsigned timestamp, unsigned latency, unsigned hops, unsigned size, unsigned weight)
+{
+	memphis_sec_monitor_t monitor;
+	monitor.prod      = prod;
+	monitor.cons      = cons;
+	monitor.service   = SEC_MONITOR;
+	monitor.app       = (prod >> 8) & 0xFF;
+	monitor.timestamp = timestamp;
+	monitor.latency   = latency;
+	monitor.hops      = hops;
+	monitor.size      = size;
+	monitor.weight    = weight;
+	monitor.pad16     = 0;
+
+	mpipe_write(&monitor, sizeof(memphis_sec_monitor_t), _observers[MON_SEC].addr);
+}
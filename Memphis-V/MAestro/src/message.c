@@ -25,6 +25,7 @@
 #include <rpc.h>
 #include <llm.h>
 #include <task_migration.h>
+#include <slack.h>
 
 #include <memphis.h>
 #include <memphis/services.h>
@@ -33,6 +34,10 @@
 
 list_t _msg_pndg;
 
+/* Reused buffer for kernel-directed deliveries */
+void  *_msg_kbuf      = NULL;
+size_t _msg_kbuf_size = 0;
+
 /**
  * @brief Forwards a DATA_AV/MESSAGE_REQUEST in case of migration
  * 
@@ -56,6 +61,22 @@ int _msg_forward_hdshk(msg_hdshk_t *hdshk, uint16_t task);
  */
 void _msg_update_tl(tcb_t *tcb, uint32_t source, int16_t task, int8_t src_app);
 
+/**
+ * @brief Dispatches every service request of a RPC_BATCH message
+ * 
+ * @details A failed request does not stop the batch: the remaining requests
+ * are still dispatched and the number of failures is logged
+ * 
+ * @param batch Pointer to the batch message
+ * @param size Size of the batch message
+ * 
+ * @return int
+ *  -EINVAL if the batch is malformed, stopping at the malformed request
+ *  1 if the scheduler should be called
+ *  0 otherwise
+ */
+int _msg_dispatch_batch(void *batch, size_t size);
+
 void msg_pndg_init()
 {
     list_init(&_msg_pndg);
@@ -118,7 +139,7 @@ int msg_recv_data_av(msg_hdshk_t *hdshk)
     sched_t *sched = tcb_get_sched(recv_tcb);
     if (sched_is_waiting_dav(sched)) {
         sched_release_wait(sched);
-        return sched_is_idle();
+        return sched_is_idle() || slack_should_preempt(hdshk->receiver);
     }
 
     return 0;
@@ -216,11 +237,13 @@ int msg_recv_message_request(msg_hdshk_t *hdshk)
 		sched_release_wait(sched);
 
 		if (tcb_need_migration(recv_tcb)) {
+			slack_remove(hdshk->receiver);
+			llm_sec_flush(hdshk->receiver);
 			tm_migrate(recv_tcb);
 			return 1;
 		}
 
-        return sched_is_idle();
+        return sched_is_idle() || slack_should_preempt(hdshk->receiver);
     }
 
 	/* Send through NoC */
@@ -234,9 +257,13 @@ int msg_recv_message_request(msg_hdshk_t *hdshk)
 	sched_t *sched = tcb_get_sched(send_tcb);
 	if (sched_is_waiting_msgreq(sched)) {
 		sched_release_wait(sched);
-		if (tcb_has_called_exit(send_tcb))
+		if (tcb_has_called_exit(send_tcb)) {
+			slack_remove(hdshk->sender);
+			llm_sec_flush(hdshk->sender);
 			tcb_terminate(send_tcb);
-        return sched_is_idle();
+			return sched_is_idle();
+		}
+        return sched_is_idle() || slack_should_preempt(hdshk->sender);
 	}
 
     return 0;
@@ -251,15 +278,23 @@ int msg_recv_message_delivery(msg_dlv_t *dlv)
         // printf("Kernel message!\n");
 		/* This message was directed to kernel */
 		size_t align_size = (dlv->size + 3) & ~3;
-		void *rcvmsg = malloc(align_size);
-		dmni_recv(rcvmsg, align_size);
-
-		/* Process the message like a syscall triggered from another PE */
-		int ret = rpc_hermes_dispatcher(rcvmsg, dlv->size);
+		if (align_size > _msg_kbuf_size) {
+			void *buf = realloc(_msg_kbuf, align_size);
+			if (buf == NULL) {
+				dmni_drop_payload(align_size);
+				return -ENOMEM;
+			}
+			_msg_kbuf      = buf;
+			_msg_kbuf_size = align_size;
+		}
+		dmni_recv(_msg_kbuf, align_size);
 
-		free(rcvmsg);
+		memphis_info_t *info = _msg_kbuf;
+		if (info->service == RPC_BATCH)
+			return _msg_dispatch_batch(_msg_kbuf, dlv->size);
 
-		return ret;
+		/* Process the message like a syscall triggered from another PE */
+		return rpc_hermes_dispatcher(_msg_kbuf, dlv->size);
 	}
 
     tcb_t *recv_tcb = tcb_find(dlv->hdshk.receiver);
@@ -312,11 +347,13 @@ int msg_recv_message_delivery(msg_dlv_t *dlv)
     sched_release_wait(sched);
 
     if (tcb_need_migration(recv_tcb)) {
+        slack_remove(dlv->hdshk.receiver);
+        llm_sec_flush(dlv->hdshk.receiver);
         tm_migrate(recv_tcb);
         return 1;
     }
 
-    return sched_is_idle();
+    return sched_is_idle() || slack_should_preempt(dlv->hdshk.receiver);
 }
 
 int msg_send_hdshk(uint32_t source, uint32_t target, uint16_t sender, uint16_t receiver, uint8_t service)
@@ -380,3 +417,38 @@ void _msg_update_tl(tcb_t *tcb, uint32_t source, int16_t task, int8_t src_app)
         app_update(app, task, source);
     }
 }
+
+int _msg_dispatch_batch(void *batch, size_t size)
+{
+    if (size < sizeof(memphis_rpc_batch_t))
+        return -EINVAL;
+
+    memphis_rpc_batch_t *header = batch;
+    uint8_t *tail = (uint8_t*)batch + sizeof(memphis_rpc_batch_t);
+    uint8_t *end  = (uint8_t*)batch + size;
+
+    int need_sched = 0;
+    int failed = 0;
+    for (int i = 0; i < header->cnt; i++) {
+        if (tail + sizeof(uint32_t) > end)
+            return -EINVAL;
+
+        uint32_t req_size = *(uint32_t*)tail;
+        tail += sizeof(uint32_t);
+        if (tail + req_size > end)
+            return -EINVAL;
+
+        int ret = rpc_hermes_dispatcher(tail, req_size);
+        if (ret < 0)
+            failed++;
+        else
+            need_sched |= ret;
+
+        tail += (req_size + 3) & ~3;
+    }
+
+    if (failed != 0)
+        printf("RPC_BATCH: %d of %d requests failed\n", failed, header->cnt);
+
+    return need_sched;
+}
@@ -0,0 +1,156 @@
+/**
+ * MAestro
+ * @file slack.c
+ *
+ * @date October 2026
+ *
+ * @brief Least-slack preemption hint for real-time tasks
+ */
+
+#include <slack.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <task_control.h>
+#include <task_scheduler.h>
+
+#define SLACK_MAX_TASKS 16
+
+typedef struct _slack_task {
+	bool     used;
+	bool     missed;	/* Miss already counted */
+	int16_t  id;
+	uint32_t slack;
+	uint32_t remaining;
+	unsigned misses;
+} slack_task_t;
+
+static slack_task_t _slack_tasks[SLACK_MAX_TASKS];
+static bool         _slack_enabled = SLACK_PREEMPT;
+
+/**
+ * @brief Finds a task in the slack table
+ *
+ * @param id ID of the task
+ * @return Pointer to the entry, NULL if not found
+ */
+slack_task_t *_slack_find(int id);
+
+/**
+ * @brief Gets a free entry of the slack table
+ *
+ * @details When full, reclaims the entry of a task no longer in this PE
+ *
+ * @return Pointer to the entry, NULL if the table is full
+ */
+slack_task_t *_slack_alloc();
+
+/**
+ * @brief Frees an entry of the slack table, logging its deadline misses
+ *
+ * @param task Pointer to the entry
+ */
+void _slack_release(slack_task_t *task);
+
+void slack_init()
+{
+	for (int i = 0; i < SLACK_MAX_TASKS; i++)
+		_slack_tasks[i].used = false;
+}
+
+void slack_set_enabled(bool enabled)
+{
+	_slack_enabled = enabled;
+}
+
+void slack_update(int id, unsigned slack_time, unsigned remaining_exec_time)
+{
+	slack_task_t *task = _slack_find(id);
+	if (task == NULL) {
+		task = _slack_alloc();
+		if (task == NULL)
+			return;
+
+		task->used   = true;
+		task->id     = id;
+		task->missed = false;
+		task->misses = 0;
+	}
+
+	task->slack     = slack_time;
+	task->remaining = remaining_exec_time;
+
+	if (slack_time == 0 && remaining_exec_time > 0) {
+		if (!task->missed) {
+			task->missed = true;
+			task->misses++;
+		}
+	} else {
+		task->missed = false;
+	}
+}
+
+void slack_remove(int id)
+{
+	slack_task_t *task = _slack_find(id);
+	if (task != NULL)
+		_slack_release(task);
+}
+
+bool slack_should_preempt(int id)
+{
+	if (!_slack_enabled)
+		return false;
+
+	slack_task_t *released = _slack_find(id);
+	if (released == NULL)	/* Not real-time */
+		return false;
+
+	tcb_t *current = sched_get_current_tcb();
+	if (current == NULL)
+		return true;
+
+	slack_task_t *running = _slack_find(tcb_get_id(current));
+	if (running == NULL)	/* Best-effort tasks always yield to real-time */
+		return true;
+
+	return (released->slack < running->slack);
+}
+
+slack_task_t *_slack_find(int id)
+{
+	for (int i = 0; i < SLACK_MAX_TASKS; i++) {
+		if (_slack_tasks[i].used && _slack_tasks[i].id == id)
+			return &_slack_tasks[i];
+	}
+
+	return NULL;
+}
+
+slack_task_t *_slack_alloc()
+{
+	for (int i = 0; i < SLACK_MAX_TASKS; i++) {
+		if (!_slack_tasks[i].used)
+			return &_slack_tasks[i];
+	}
+
+	/* Terminated or migrated without slack_remove */
+	for (int i = 0; i < SLACK_MAX_TASKS; i++) {
+		if (tcb_find(_slack_tasks[i].id) == NULL) {
+			_slack_release(&_slack_tasks[i]);
+			return &_slack_tasks[i];
+		}
+	}
+
+	return NULL;
+}
+
+void _slack_release(slack_task_t *task)
+{
+	if (task->misses > 0)
+		printf("Task %d missed %u deadlines\n", task->id, task->misses);
+
+	task->used = false;
+}
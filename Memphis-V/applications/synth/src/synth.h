@@ -0,0 +1,218 @@
+/**
+ * MA-Memphis
+ * @file synth.h
+ *
+ * @date October 2026
+ *
+ * @brief Synthetic NoC traffic generator shared by all synth tasks
+ *
+ * @details Each participating PE runs an injector and a sink, statically
+ * mapped by the scenario. Traffic patterns are computed on the PE
+ * coordinates listed in synth_map.h. Injectors never receive, so injection
+ * is open-loop: message i of an injector is scheduled at start + i*period and
+ * carries that tick, so the latency measured by the sink includes the time
+ * the message waited at the source. This is the application-level latency,
+ * which also includes the handshake and the sink scheduling.
+ *
+ * Task indices follow the order of the task names:
+ * synth_gen_inj_<idx> are 0..SYNTH_PES-1 and synth_gen_sink_<idx> follow them.
+ * Both the tasks and synth_map.h are generated by
+ * sim/sandbox/bench/synth_sweep.py for the testcase mesh.
+ *
+ * Each task prints one CSV line:
+ * SYNTH_INJ,<pattern>,<idx>,<size>,<period>,<sent>,<start>,<end>
+ * SYNTH_SINK,<pattern>,<idx>,<size>,<recv>,<lat_avg>,<lat_max>,<start>,<end>
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <memphis.h>
+
+enum SYNTH_PATTERNS {
+	SYNTH_UNIFORM,		/* Random permutation of the PEs, changed every round */
+	SYNTH_TRANSPOSE,	/* (x, y) -> (y, x) */
+	SYNTH_BITCOMP,		/* (x, y) -> (X - 1 - x, Y - 1 - y) */
+	SYNTH_HOTSPOT,		/* All -> PE (X/2, Y/2) */
+	SYNTH_NEIGHBOR		/* (x, y) -> (x + 1 mod X, y) */
+};
+
+#include "synth_cfg.h"
+#include "synth_map.h"	/* SYNTH_DIM_X, SYNTH_DIM_Y, SYNTH_PES and _synth_pes[] */
+
+#if SYNTH_MSG_SIZE < 2
+#error "SYNTH_MSG_SIZE must hold the injection tick and the round (2 words)"
+#endif
+
+#define SYNTH_SINK(idx) (SYNTH_PES + (idx))
+
+/**
+ * @brief Finds the synth index of a PE
+ *
+ * @param x PE X coordinate
+ * @param y PE Y coordinate
+ * @return Index, -1 if the PE does not take part
+ */
+static int _synth_find(int x, int y)
+{
+	const int addr = (x << 8) | y;
+	for (int i = 0; i < SYNTH_PES; i++) {
+		if (_synth_pes[i] == addr)
+			return i;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Gets the destination of every injector in a round
+ *
+ * @param round Round number
+ * @param dst Array to store the destination index, -1 if it does not send
+ */
+static void _synth_round(unsigned round, int *dst)
+{
+	if (SYNTH_PATTERN == SYNTH_UNIFORM) {
+		uint32_t seed = 0x9E3779B9 ^ (round * 2654435761u);
+
+		for (int i = 0; i < SYNTH_PES; i++)
+			dst[i] = i;
+
+		for (int i = SYNTH_PES - 1; i > 0; i--) {
+			seed = seed * 1664525 + 1013904223;
+			int j = (seed >> 16) % (i + 1);
+			int tmp = dst[i];
+			dst[i] = dst[j];
+			dst[j] = tmp;
+		}
+	} else {
+		for (int i = 0; i < SYNTH_PES; i++) {
+			const int x = _synth_pes[i] >> 8;
+			const int y = _synth_pes[i] & 0xFF;
+
+			switch (SYNTH_PATTERN) {
+				case SYNTH_TRANSPOSE:
+					dst[i] = _synth_find(y % SYNTH_DIM_X, x % SYNTH_DIM_Y);
+					break;
+				case SYNTH_BITCOMP:
+					dst[i] = _synth_find(SYNTH_DIM_X - 1 - x, SYNTH_DIM_Y - 1 - y);
+					break;
+				case SYNTH_HOTSPOT:
+					dst[i] = _synth_find(SYNTH_DIM_X / 2, SYNTH_DIM_Y / 2);
+					break;
+				case SYNTH_NEIGHBOR:
+				default:
+					dst[i] = _synth_find((x + 1) % SYNTH_DIM_X, y);
+					break;
+			}
+		}
+	}
+
+	for (int i = 0; i < SYNTH_PES; i++) {
+		if (dst[i] == i)
+			dst[i] = -1;
+	}
+}
+
+/**
+ * @brief Injects the synthetic traffic of a PE
+ *
+ * @param idx Index of the PE
+ * @return 0
+ */
+static inline int synth_inject(int idx)
+{
+	static uint32_t msg[SYNTH_MSG_SIZE];
+	static int dst[SYNTH_PES];
+
+	for (int i = 0; i < SYNTH_MSG_SIZE; i++)
+		msg[i] = idx;
+
+	unsigned sent = 0;
+	const unsigned start = memphis_get_tick();
+
+	for (unsigned round = 0; round < SYNTH_ROUNDS; round++) {
+		/* Open-loop: the schedule does not wait for late sends */
+		const unsigned scheduled = start + round * SYNTH_PERIOD;
+		while ((int)(memphis_get_tick() - scheduled) < 0);
+
+		_synth_round(round, dst);
+		if (dst[idx] == -1)
+			continue;
+
+		msg[0] = scheduled;
+		msg[1] = round;
+		memphis_send(msg, sizeof(msg), SYNTH_SINK(dst[idx]));
+		sent++;
+	}
+
+	const unsigned end = memphis_get_tick();
+
+	printf(
+		"SYNTH_INJ,%d,%d,%d,%d,%u,%u,%u\n",
+		SYNTH_PATTERN,
+		idx,
+		SYNTH_MSG_SIZE,
+		SYNTH_PERIOD,
+		sent,
+		start,
+		end
+	);
+
+	return 0;
+}
+
+/**
+ * @brief Receives the synthetic traffic directed to a PE
+ *
+ * @param idx Index of the PE
+ * @return 0
+ */
+static inline int synth_sink(int idx)
+{
+	static uint32_t msg[SYNTH_MSG_SIZE];
+	static int dst[SYNTH_PES];
+
+	unsigned expected = 0;
+	for (unsigned round = 0; round < SYNTH_ROUNDS; round++) {
+		_synth_round(round, dst);
+		for (int src = 0; src < SYNTH_PES; src++) {
+			if (dst[src] == idx)
+				expected++;
+		}
+	}
+
+	unsigned recv    = 0;
+	uint64_t lat_sum = 0;
+	unsigned lat_max = 0;
+
+	const unsigned start = memphis_get_tick();
+
+	while (recv < expected) {
+		memphis_receive_any(msg, sizeof(msg));
+		unsigned latency = memphis_get_tick() - msg[0];
+		lat_sum += latency;
+		if (latency > lat_max)
+			lat_max = latency;
+		recv++;
+	}
+
+	const unsigned end = memphis_get_tick();
+
+	printf(
+		"SYNTH_SINK,%d,%d,%d,%u,%u,%u,%u,%u\n",
+		SYNTH_PATTERN,
+		idx,
+		SYNTH_MSG_SIZE,
+		recv,
+		(recv > 0) ? (unsigned)(lat_sum / recv) : 0,
+		lat_max,
+		start,
+		end
+	);
+
+	return 0;
+}
@@ -0,0 +1,28 @@
+/**
+ * MA-Memphis
+ * @file synth_cfg.h
+ *
+ * @date October 2026
+ * 
+ * @brief Default synthetic traffic parameters
+ *
+ * @details sim/sandbox/bench/synth_sweep.py overrides them with -D flags
+ */
+
+#pragma once
+
+#ifndef SYNTH_PATTERN
+#define SYNTH_PATTERN  SYNTH_NEIGHBOR
+#endif
+
+#ifndef SYNTH_MSG_SIZE
+#define SYNTH_MSG_SIZE 64		/* Message size in 32-bit words */
+#endif
+
+#ifndef SYNTH_PERIOD
+#define SYNTH_PERIOD   10000	/* Ticks between injections. 0 injects back-to-back */
+#endif
+
+#ifndef SYNTH_ROUNDS
+#define SYNTH_ROUNDS   100
+#endif
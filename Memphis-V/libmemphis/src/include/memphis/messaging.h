@@ -64,6 +64,15 @@ typedef struct _memphis_new_app {
     /* communication*sizeof(int32_t) */
 } memphis_new_app_t;
 
+typedef struct _memphis_rpc_batch {
+    /* {cnt, service, pad16} */
+    uint16_t pad16;
+    uint8_t  service;
+    uint8_t  cnt;
+
+    /* cnt * {uint32_t size, message padded to 4 bytes} */
+} memphis_rpc_batch_t;
+
 typedef struct _memphis_qos_monitor {
     /* {pad8, service, task} */
     uint16_t task;
@@ -75,6 +84,10 @@ typedef struct _memphis_qos_monitor {
     uint32_t remaining_exec_time;
 } memphis_qos_monitor_t;
 
+/**
+ * A SEC record represents weight messages of a flow, with their mean latency
+ * and size. See memphis/sec_estimate.h to estimate the full traffic.
+ */
 typedef struct _memphis_sec_monitor {
     /* {app, service, task} */
     uint8_t  prod;
@@ -88,6 +101,9 @@ typedef struct _memphis_sec_monitor {
 
     uint16_t hops;
     uint16_t size;    /* Theoretical max. 32 bits */
+
+    uint16_t weight;  /* Messages represented by this record */
+    uint16_t pad16;
 } memphis_sec_monitor_t;
 
 typedef struct _memphis_vol_monitor {
@@ -98,3 +114,31 @@ typedef struct _memphis_vol_monitor {
     uint16_t hops;
     uint16_t size;
 } memphis_vol_monitor_t;
+
+#define VOL_AGGREGATE_MAX 15
+
+typedef struct _memphis_vol_bucket {
+    uint16_t hops;
+    uint16_t pad16;
+
+    uint32_t flits;
+} memphis_vol_bucket_t;
+
+typedef struct _memphis_vol_aggregate {
+    /* {last, service, cnt} */
+    uint16_t cnt;
+    uint8_t  service;
+    uint8_t  last;  /* Set in the final message of a partial result */
+
+    /* Only cnt buckets are sent */
+    memphis_vol_bucket_t buckets[VOL_AGGREGATE_MAX];
+} memphis_vol_aggregate_t;
+
+typedef struct _memphis_sink {
+    /* {cnt, service, size} */
+    uint16_t size;    /* Bytes of records after this header */
+    uint8_t  service;
+    uint8_t  cnt;
+
+    /* cnt * {uint16_t size, uint16_t tag, record padded to 4 bytes} */
+} memphis_sink_t;
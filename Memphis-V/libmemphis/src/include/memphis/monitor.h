@@ -19,6 +19,20 @@
 
 #define MON_INTERVAL_QOS 50000
 
+/* SEC monitoring sampling modes */
+#define MON_SEC_FULL		0	/* Every message */
+#define MON_SEC_FIXED		1	/* 1 of each MON_SEC_RATE messages per flow */
+#define MON_SEC_ADAPTIVE	2	/* Up to 1 of MON_SEC_RATE while the flow is steady */
+
+#ifndef MON_SEC_SAMPLING
+#define MON_SEC_SAMPLING MON_SEC_FULL
+#endif
+
+#define MON_SEC_RATE 16
+
+/* Ticks without messages after which the pending run of a flow is sent */
+#define MON_SEC_MAX_AGE (2*MON_INTERVAL_QOS)
+
 enum MONITOR_TYPE {
 	MON_QOS,
 	MON_SEC,
@@ -30,6 +30,10 @@
 
 #define A_MIGRATION	0x01000000
 
+#ifndef ODA_CACHE_TTL
+#define ODA_CACHE_TTL 1000000	/* Ticks a cached provider is trusted */
+#endif
+
 #define SAFE_HASH_aes		  0x350AC39A
 #define SAFE_HASH_audio_video 0x638E8D3B
 #define SAFE_HASH_dijkstra    0x8C9F31AB
@@ -137,3 +141,59 @@ bool oda_is_enabled(oda_t *oda);
  * @return int ID of the task
  */
 int oda_get_id(oda_t *oda);
+
+/**
+ * @brief Requests the nearest ODA service through the discovery cache
+ * 
+ * @details Only issues a REQUEST_NEAREST_SERVICE when type_tag is not cached
+ * or its entry is older than ODA_CACHE_TTL
+ * 
+ * @param oda Pointer to the ODA
+ * @param type_tag Flags of the desired ODA capabilities
+ * 
+ * @return Same as oda_request_nearest_service
+ */
+int oda_cache_nearest(oda_t *oda, int type_tag);
+
+/**
+ * @brief Requests all servers of an ODA service through the discovery cache
+ * 
+ * @details Only issues a REQUEST_ALL_SERVICES when type_tag is not cached
+ * or its entry is older than ODA_CACHE_TTL. The IDs are copied to the
+ * caller storage, so the list stays valid after the cache drops the entry.
+ * 
+ * @param servers Pointer to the ODA list, its ids will point to ids
+ * @param type_tag Flags of the desired ODA capabilities
+ * @param ids Array to store the server IDs
+ * @param max_ids Size of the ids array
+ * 
+ * @return Same as oda_request_all_services, and
+ * -ENOSPC more than max_ids servers (only the first max_ids are copied)
+ */
+int oda_cache_all(oda_list_t *servers, int type_tag, int *ids, int max_ids);
+
+/**
+ * @brief Invalidates cached providers affected by a received message
+ * 
+ * @details Should be called with every message received by a task that uses
+ * the cache. TERMINATE_ODA drops every entry. TASK_MIGRATED, received by the
+ * mapper, drops the nearest providers, as migration keeps the IDs but changes
+ * the distances.
+ * 
+ * @param msg Pointer to the received message
+ */
+void oda_cache_handle(void *msg);
+
+/**
+ * @brief Drops the cached providers of a type tag
+ * 
+ * @details Should be called when a cached provider stops answering
+ * 
+ * @param type_tag Flags of the ODA capabilities
+ */
+void oda_cache_drop(int type_tag);
+
+/**
+ * @brief Drops all cached providers
+ */
+void oda_cache_invalidate();
@@ -0,0 +1,61 @@
+/**
+ * libmemphis
+ * @file rpc_batch.h
+ *
+ * @date October 2026
+ *
+ * @brief Packs several kernel service requests in a single message
+ *
+ * @details The kernel applies each request of a batch independently: a
+ * failed request does not stop or undo the others, and the sender is not
+ * notified of the failure. The kernel only logs the failure count.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _rpc_batch {
+	void  *buf;
+	size_t capacity;
+	size_t size;
+} rpc_batch_t;
+
+/**
+ * @brief Initializes an empty RPC_BATCH message
+ * 
+ * @param batch Pointer to the batch
+ * @param buf Buffer to hold the message (4-byte aligned)
+ * @param capacity Size of the buffer in bytes
+ */
+void rpc_batch_init(rpc_batch_t *batch, void *buf, size_t capacity);
+
+/**
+ * @brief Appends a service request to the batch
+ * 
+ * @param batch Pointer to the batch
+ * @param msg Pointer to the service request
+ * @param size Size of the service request in bytes
+ * 
+ * @return
+ *  0 success
+ * -ENOSPC the buffer or the request count is full
+ */
+int rpc_batch_append(rpc_batch_t *batch, void *msg, size_t size);
+
+/**
+ * @brief Gets the number of requests in the batch
+ * 
+ * @param batch Pointer to the batch
+ * @return Number of requests
+ */
+unsigned rpc_batch_count(rpc_batch_t *batch);
+
+/**
+ * @brief Gets the size of the batch message to send
+ * 
+ * @param batch Pointer to the batch
+ * @return Size in bytes
+ */
+size_t rpc_batch_size(rpc_batch_t *batch);
@@ -0,0 +1,64 @@
+/**
+ * libmemphis
+ * @file sec_estimate.h
+ *
+ * @date October 2026
+ *
+ * @brief Estimates the full traffic of a flow from sampled SEC records
+ *
+ * @details With MON_SEC_SAMPLING other than MON_SEC_FULL, a SEC record stands
+ * for weight messages of its flow. Observers and deciders should add every
+ * record to an estimate instead of counting records.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memphis/messaging.h>
+
+typedef struct _sec_estimate {
+	uint32_t messages;
+	uint32_t volume;	/* Flits */
+	uint64_t lat_sum;
+	uint32_t lat_max;	/* Of the reported latencies (means for runs) */
+} sec_estimate_t;
+
+/**
+ * @brief Initializes an empty estimate
+ * 
+ * @param est Pointer to the estimate
+ */
+void sec_estimate_init(sec_estimate_t *est);
+
+/**
+ * @brief Adds a SEC record to the estimate
+ * 
+ * @param est Pointer to the estimate
+ * @param monitor Pointer to the SEC record
+ */
+void sec_estimate_add(sec_estimate_t *est, memphis_sec_monitor_t *monitor);
+
+/**
+ * @brief Gets the estimated number of messages
+ * 
+ * @param est Pointer to the estimate
+ * @return Number of messages
+ */
+unsigned sec_estimate_messages(sec_estimate_t *est);
+
+/**
+ * @brief Gets the estimated traffic volume
+ * 
+ * @param est Pointer to the estimate
+ * @return Volume in flits
+ */
+unsigned sec_estimate_volume(sec_estimate_t *est);
+
+/**
+ * @brief Gets the estimated mean latency
+ * 
+ * @param est Pointer to the estimate
+ * @return Mean latency in ticks, 0 if no messages
+ */
+unsigned sec_estimate_latency(sec_estimate_t *est);
@@ -42,6 +42,7 @@
 #define TASK_TERMINATED				0x06
 #define TASK_ABORTED				0x07
 #define TASK_MIGRATED				0x08
+#define RPC_BATCH					0x09
 
 #define REQUEST_FINISH				0x10
 #define PE_HALTED					0x11
@@ -62,6 +63,9 @@
 #define SEC_SAFE_MAP_RESP           0x28
 #define SEC_MONITOR					0x29
 #define VOL_MONITOR		            0x30
+#define VOL_AGGREGATE               0x31
+#define MON_SINK_DATA               0x32
+#define VOL_AGGREGATE_JOIN          0x33
 
 /* Broadcast messages 0x80-0x8F */
 #define RELEASE_PERIPHERAL          0x80
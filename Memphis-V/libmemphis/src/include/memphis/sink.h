@@ -0,0 +1,66 @@
+/**
+ * libmemphis
+ * @file sink.h
+ *
+ * @date October 2026
+ *
+ * @brief Streams monitoring records to the host through the MON_SINK peripheral
+ *
+ * @details Records are sent with memphis_send_any forced to a border port, so
+ * the peripheral must follow the message handshake like a consumer task: it
+ * answers every DATA_AV with a MESSAGE_REQUEST. Each flush waits for the
+ * previous message to be requested, so it blocks while the peripheral is not
+ * answering.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SINK_BUF_SIZE 512
+
+/* Must match the MON_SINK placement in the testcase */
+#ifndef SINK_PE
+#define SINK_PE 0x0200
+#endif
+
+#ifndef SINK_PORT
+#define SINK_PORT SINK_EAST
+#endif
+
+enum SINK_PORTS {
+	SINK_EAST,
+	SINK_WEST,
+	SINK_NORTH,
+	SINK_SOUTH
+};
+
+/**
+ * @brief Appends a record to the sink stream
+ * 
+ * @details Records are buffered and sent in a single message when the buffer
+ * is full
+ * 
+ * @param tag Type of the record, usually the service that produced it
+ * @param rec Pointer to the record
+ * @param size Size of the record in bytes
+ * 
+ * @return
+ *  0 success
+ * -EINVAL record larger than the sink buffer
+ * <0 error sending a full buffer (the record is not appended)
+ */
+int sink_write(uint16_t tag, void *rec, size_t size);
+
+/**
+ * @brief Sends the buffered records to the sink peripheral
+ * 
+ * @details Blocks until the peripheral requests the previously sent message.
+ * On error the records stay buffered for the next flush.
+ * 
+ * @return
+ *  0 success
+ * <0 error sending
+ */
+int sink_flush();
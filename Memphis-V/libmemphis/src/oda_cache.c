@@ -0,0 +1,159 @@
+/**
+ * libmemphis
+ * @file oda_cache.c
+ *
+ * @date October 2026
+ *
+ * @brief Cache of resolved ODA service providers
+ */
+
+#include <memphis/oda.h>
+
+#include <stdlib.h>
+#include <errno.h>
+
+#include <memphis.h>
+#include <memphis/messaging.h>
+#include <memphis/services.h>
+
+#define ODA_CACHE_SIZE 8
+
+typedef struct _oda_cache_entry {
+	int tag;		/* 0 if the entry is free */
+	int nearest;	/* -1 if not resolved */
+	unsigned tick;	/* Allocation time */
+	oda_list_t all;	/* ids == NULL if not resolved */
+} oda_cache_entry_t;
+
+static oda_cache_entry_t _oda_cache[ODA_CACHE_SIZE];
+static unsigned _oda_cache_victim = 0;
+
+/**
+ * @brief Gets the cache entry of a type tag, allocating it if needed
+ *
+ * @param type_tag Flags of the desired ODA capabilities
+ *
+ * @details Entries older than ODA_CACHE_TTL are dropped and allocated again
+ *
+ * @return Pointer to the entry
+ */
+oda_cache_entry_t *_oda_cache_get(int type_tag);
+
+/**
+ * @brief Frees a cache entry
+ *
+ * @param entry Pointer to the entry
+ */
+void _oda_cache_drop(oda_cache_entry_t *entry);
+
+int oda_cache_nearest(oda_t *oda, int type_tag)
+{
+	oda_cache_entry_t *entry = _oda_cache_get(type_tag);
+
+	if (entry->nearest != -1) {
+		oda->id  = entry->nearest;
+		oda->tag = type_tag;
+		return 0;
+	}
+
+	int ret = oda_request_nearest_service(oda, type_tag);
+	if (ret == 0 && oda_is_enabled(oda))
+		entry->nearest = oda_get_id(oda);
+
+	return ret;
+}
+
+int oda_cache_all(oda_list_t *servers, int type_tag, int *ids, int max_ids)
+{
+	oda_cache_entry_t *entry = _oda_cache_get(type_tag);
+
+	if (entry->all.ids == NULL) {
+		int ret = oda_request_all_services(&entry->all, type_tag);
+		if (ret != 0)
+			return ret;
+	}
+
+	const int cnt = (entry->all.cnt < max_ids) ? entry->all.cnt : max_ids;
+	for (int i = 0; i < cnt; i++)
+		ids[i] = entry->all.ids[i];
+
+	servers->tag = entry->all.tag;
+	servers->cnt = cnt;
+	servers->ids = ids;
+
+	return (entry->all.cnt > max_ids) ? -ENOSPC : 0;
+}
+
+void oda_cache_handle(void *msg)
+{
+	const memphis_info_t *info = msg;
+
+	switch (info->service) {
+		case TERMINATE_ODA:
+			/* Providers are terminating */
+			oda_cache_invalidate();
+			break;
+		case TASK_MIGRATED:
+			/* IDs survive migration, only the distances change */
+			for (int i = 0; i < ODA_CACHE_SIZE; i++)
+				_oda_cache[i].nearest = -1;
+			break;
+		default:
+			break;
+	}
+}
+
+void oda_cache_drop(int type_tag)
+{
+	for (int i = 0; i < ODA_CACHE_SIZE; i++) {
+		if (_oda_cache[i].tag == type_tag)
+			_oda_cache_drop(&_oda_cache[i]);
+	}
+}
+
+void oda_cache_invalidate()
+{
+	for (int i = 0; i < ODA_CACHE_SIZE; i++) {
+		if (_oda_cache[i].tag != 0)
+			_oda_cache_drop(&_oda_cache[i]);
+	}
+}
+
+oda_cache_entry_t *_oda_cache_get(int type_tag)
+{
+	const unsigned now = memphis_get_tick();
+
+	oda_cache_entry_t *free_entry = NULL;
+	for (int i = 0; i < ODA_CACHE_SIZE; i++) {
+		if (_oda_cache[i].tag != 0 && now - _oda_cache[i].tick > ODA_CACHE_TTL)
+			_oda_cache_drop(&_oda_cache[i]);
+
+		if (_oda_cache[i].tag == type_tag)
+			return &_oda_cache[i];
+
+		if (free_entry == NULL && _oda_cache[i].tag == 0)
+			free_entry = &_oda_cache[i];
+	}
+
+	if (free_entry == NULL) {
+		/* Cache full: replace in round-robin */
+		free_entry = &_oda_cache[_oda_cache_victim];
+		_oda_cache_victim = (_oda_cache_victim + 1) % ODA_CACHE_SIZE;
+		_oda_cache_drop(free_entry);
+	}
+
+	free_entry->tag     = type_tag;
+	free_entry->nearest = -1;
+	free_entry->tick    = now;
+	oda_list_init(&free_entry->all);
+
+	return free_entry;
+}
+
+void _oda_cache_drop(oda_cache_entry_t *entry)
+{
+	free(entry->all.ids);
+	entry->all.ids = NULL;
+	entry->tag     = 0;
+	entry->nearest = -1;
+}
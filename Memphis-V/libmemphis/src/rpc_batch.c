@@ -0,0 +1,58 @@
+/**
+ * libmemphis
+ * @file rpc_batch.c
+ *
+ * @date October 2026
+ *
+ * @brief Packs several kernel service requests in a single message
+ */
+
+#include <memphis/rpc_batch.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <memphis/messaging.h>
+#include <memphis/services.h>
+
+void rpc_batch_init(rpc_batch_t *batch, void *buf, size_t capacity)
+{
+	batch->buf      = buf;
+	batch->capacity = capacity;
+	batch->size     = sizeof(memphis_rpc_batch_t);
+
+	memphis_rpc_batch_t *header = buf;
+	header->pad16   = 0;
+	header->service = RPC_BATCH;
+	header->cnt     = 0;
+}
+
+int rpc_batch_append(rpc_batch_t *batch, void *msg, size_t size)
+{
+	memphis_rpc_batch_t *header = batch->buf;
+	if (header->cnt == UINT8_MAX)
+		return -ENOSPC;
+
+	size_t align_size = (size + 3) & ~3;
+	if (batch->size + sizeof(uint32_t) + align_size > batch->capacity)
+		return -ENOSPC;
+
+	uint8_t *tail = (uint8_t*)batch->buf + batch->size;
+	*(uint32_t*)tail = size;
+	memcpy(tail + sizeof(uint32_t), msg, size);
+
+	batch->size += sizeof(uint32_t) + align_size;
+	header->cnt++;
+
+	return 0;
+}
+
+unsigned rpc_batch_count(rpc_batch_t *batch)
+{
+	return ((memphis_rpc_batch_t*)batch->buf)->cnt;
+}
+
+size_t rpc_batch_size(rpc_batch_t *batch)
+{
+	return batch->size;
+}
@@ -0,0 +1,46 @@
+/**
+ * libmemphis
+ * @file sec_estimate.c
+ *
+ * @date October 2026
+ *
+ * @brief Estimates the full traffic of a flow from sampled SEC records
+ */
+
+#include <memphis/sec_estimate.h>
+
+void sec_estimate_init(sec_estimate_t *est)
+{
+	est->messages = 0;
+	est->volume   = 0;
+	est->lat_sum  = 0;
+	est->lat_max  = 0;
+}
+
+void sec_estimate_add(sec_estimate_t *est, memphis_sec_monitor_t *monitor)
+{
+	est->messages += monitor->weight;
+	est->volume   += monitor->size * monitor->weight;
+	est->lat_sum  += (uint64_t)monitor->latency * monitor->weight;
+
+	if (monitor->latency > est->lat_max)
+		est->lat_max = monitor->latency;
+}
+
+unsigned sec_estimate_messages(sec_estimate_t *est)
+{
+	return est->messages;
+}
+
+unsigned sec_estimate_volume(sec_estimate_t *est)
+{
+	return est->volume;
+}
+
+unsigned sec_estimate_latency(sec_estimate_t *est)
+{
+	if (est->messages == 0)
+		return 0;
+
+	return (est->lat_sum + est->messages / 2) / est->messages;
+}
@@ -0,0 +1,70 @@
+/**
+ * libmemphis
+ * @file sink.c
+ *
+ * @date October 2026
+ *
+ * @brief Streams monitoring records to the host through the MON_SINK peripheral
+ */
+
+#include <memphis/sink.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <memphis.h>
+#include <memphis/messaging.h>
+#include <memphis/services.h>
+
+static uint32_t _sink_buf[SINK_BUF_SIZE/sizeof(uint32_t)];
+static size_t   _sink_size = sizeof(memphis_sink_t);
+static unsigned _sink_cnt  = 0;
+
+int sink_write(uint16_t tag, void *rec, size_t size)
+{
+	const size_t align_size = (size + 3) & ~3;
+	const size_t rec_size   = sizeof(uint32_t) + align_size;
+
+	if (sizeof(memphis_sink_t) + rec_size > SINK_BUF_SIZE)
+		return -EINVAL;
+
+	if (_sink_size + rec_size > SINK_BUF_SIZE || _sink_cnt == UINT8_MAX) {
+		int ret = sink_flush();
+		if (ret < 0)
+			return ret;
+	}
+
+	uint8_t *tail = (uint8_t*)_sink_buf + _sink_size;
+	((uint16_t*)tail)[0] = size;
+	((uint16_t*)tail)[1] = tag;
+	memcpy(tail + sizeof(uint32_t), rec, size);
+
+	_sink_size += rec_size;
+	_sink_cnt++;
+
+	return 0;
+}
+
+int sink_flush()
+{
+	if (_sink_cnt == 0)
+		return 0;
+
+	memphis_sink_t *header = (memphis_sink_t*)_sink_buf;
+	header->size    = _sink_size - sizeof(memphis_sink_t);
+	header->service = MON_SINK_DATA;
+	header->cnt     = _sink_cnt;
+
+	int ret = memphis_send_any(
+		_sink_buf, 
+		_sink_size, 
+		MEMPHIS_FORCE_PORT | (SINK_PORT << 24) | SINK_PE
+	);
+	if (ret < 0)
+		return ret;	/* Records kept for the next flush */
+
+	_sink_size = sizeof(memphis_sink_t);
+	_sink_cnt  = 0;
+
+	return ret;
+}
@@ -0,0 +1,203 @@
+/**
+ * MA-Memphis
+ * @file slot_index.c
+ *
+ * @date October 2026
+ *
+ * @brief Spatial index of free task slots for the mapper
+ */
+
+#include "slot_index.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @brief Updates the region of a PE after its free slot count changed
+ *
+ * @param idx Pointer to the index
+ * @param x PE X coordinate
+ * @param y PE Y coordinate
+ * @param delta Change in free slots
+ */
+void _slot_update(slot_index_t *idx, int x, int y, int delta);
+
+/**
+ * @brief Gets the distance from a PE to the nearest PE of a region
+ *
+ * @param x PE X coordinate
+ * @param y PE Y coordinate
+ * @param gx Region X coordinate
+ * @param gy Region Y coordinate
+ * @return Manhattan distance
+ */
+int _slot_region_dist(int x, int y, int gx, int gy);
+
+/**
+ * @brief Checks if an address is inside the indexed mesh
+ *
+ * @param idx Pointer to the index
+ * @param addr Address of the PE
+ * @return True if inside
+ */
+bool _slot_valid(slot_index_t *idx, int addr);
+
+int slot_init(slot_index_t *idx, int dim_x, int dim_y, int tasks_per_pe)
+{
+	if (dim_x < 1 || dim_x > SLOT_MAX_DIM || dim_y < 1 || dim_y > SLOT_MAX_DIM)
+		return -EINVAL;
+
+	if (tasks_per_pe < 0 || tasks_per_pe > UINT8_MAX)
+		return -EINVAL;
+
+	idx->dim_x        = dim_x;
+	idx->dim_y        = dim_y;
+	idx->tasks_per_pe = tasks_per_pe;
+	idx->free         = 0;
+
+	for (int gx = 0; gx < SLOT_REGIONS; gx++) {
+		for (int gy = 0; gy < SLOT_REGIONS; gy++) {
+			idx->region_map[gx][gy]  = 0;
+			idx->region_free[gx][gy] = 0;
+		}
+	}
+
+	for (int x = 0; x < SLOT_MAX_DIM; x++) {
+		for (int y = 0; y < SLOT_MAX_DIM; y++) {
+			idx->pe_free[x][y] = 0;
+			if (x < dim_x && y < dim_y)
+				_slot_update(idx, x, y, tasks_per_pe);
+		}
+	}
+
+	return 0;
+}
+
+int slot_take(slot_index_t *idx, int addr)
+{
+	if (!_slot_valid(idx, addr))
+		return -EINVAL;
+
+	const int x = addr >> 8;
+	const int y = addr & 0xFF;
+
+	if (idx->pe_free[x][y] == 0)
+		return -EBUSY;
+
+	_slot_update(idx, x, y, -1);
+	return 0;
+}
+
+int slot_release(slot_index_t *idx, int addr)
+{
+	if (!_slot_valid(idx, addr))
+		return -EINVAL;
+
+	const int x = addr >> 8;
+	const int y = addr & 0xFF;
+
+	if (idx->pe_free[x][y] < idx->tasks_per_pe)
+		_slot_update(idx, x, y, 1);
+
+	return 0;
+}
+
+int slot_nearest(slot_index_t *idx, int addr)
+{
+	if (!_slot_valid(idx, addr))
+		return -EINVAL;
+
+	if (idx->free == 0)
+		return -1;
+
+	const int x  = addr >> 8;
+	const int y  = addr & 0xFF;
+	const int rx = x / SLOT_REGION;
+	const int ry = y / SLOT_REGION;
+	const int nrx = (idx->dim_x + SLOT_REGION - 1) / SLOT_REGION;
+	const int nry = (idx->dim_y + SLOT_REGION - 1) / SLOT_REGION;
+	const int rings = (nrx > nry) ? nrx : nry;
+
+	int best = -1;
+	int best_dist = idx->dim_x + idx->dim_y;
+
+	for (int r = 0; r < rings; r++) {
+		/* No PE of this ring is nearer than its inner border */
+		if (r > 0 && best_dist <= (r - 1) * SLOT_REGION + 1)
+			break;
+
+		for (int gx = rx - r; gx <= rx + r; gx++) {
+			if (gx < 0 || gx >= nrx)
+				continue;
+
+			/* Only the border of the ring: every row at the sides, two rows elsewhere */
+			const int step = (gx == rx - r || gx == rx + r) ? 1 : (2 * r);
+			for (int gy = ry - r; gy <= ry + r; gy += step) {
+				if (gy < 0 || gy >= nry || idx->region_free[gx][gy] == 0)
+					continue;
+
+				if (_slot_region_dist(x, y, gx, gy) >= best_dist)
+					continue;
+
+				uint16_t map = idx->region_map[gx][gy];
+				while (map != 0) {
+					const int bit = __builtin_ctz(map);
+					map &= map - 1;
+
+					const int px = gx * SLOT_REGION + bit % SLOT_REGION;
+					const int py = gy * SLOT_REGION + bit / SLOT_REGION;
+					const int dist = abs(px - x) + abs(py - y);
+					if (dist < best_dist) {
+						best_dist = dist;
+						best = (px << 8) | py;
+					}
+				}
+			}
+		}
+	}
+
+	return best;
+}
+
+int slot_get_free(slot_index_t *idx, int addr)
+{
+	if (!_slot_valid(idx, addr))
+		return -EINVAL;
+
+	return idx->pe_free[addr >> 8][addr & 0xFF];
+}
+
+void _slot_update(slot_index_t *idx, int x, int y, int delta)
+{
+	const int gx  = x / SLOT_REGION;
+	const int gy  = y / SLOT_REGION;
+	const int bit = (y % SLOT_REGION) * SLOT_REGION + (x % SLOT_REGION);
+
+	idx->pe_free[x][y]       += delta;
+	idx->region_free[gx][gy] += delta;
+	idx->free                += delta;
+
+	if (idx->pe_free[x][y] > 0)
+		idx->region_map[gx][gy] |= (1 << bit);
+	else
+		idx->region_map[gx][gy] &= ~(1 << bit);
+}
+
+int _slot_region_dist(int x, int y, int gx, int gy)
+{
+	const int x0 = gx * SLOT_REGION;
+	const int y0 = gy * SLOT_REGION;
+	const int dx = (x < x0) ? (x0 - x) : ((x >= x0 + SLOT_REGION) ? (x - x0 - SLOT_REGION + 1) : 0);
+	const int dy = (y < y0) ? (y0 - y) : ((y >= y0 + SLOT_REGION) ? (y - y0 - SLOT_REGION + 1) : 0);
+
+	return dx + dy;
+}
+
+bool _slot_valid(slot_index_t *idx, int addr)
+{
+	const int x = addr >> 8;
+	const int y = addr & 0xFF;
+
+	return (addr >= 0 && x < idx->dim_x && y < idx->dim_y);
+}
@@ -0,0 +1,91 @@
+/**
+ * MA-Memphis
+ * @file slot_index.h
+ *
+ * @date October 2026
+ *
+ * @brief Spatial index of free task slots for the mapper
+ *
+ * @details The mesh is split in SLOT_REGION x SLOT_REGION regions. Each region
+ * keeps a bitmap of its PEs with free slots and its free slot count, so the
+ * nearest free slot search skips full regions and stops as soon as no farther
+ * region can be nearer.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define SLOT_MAX_DIM 16
+#define SLOT_REGION  4
+#define SLOT_REGIONS (SLOT_MAX_DIM/SLOT_REGION)
+
+typedef struct _slot_index {
+	int dim_x;
+	int dim_y;
+	int tasks_per_pe;
+	unsigned free;
+
+	uint8_t  pe_free[SLOT_MAX_DIM][SLOT_MAX_DIM];
+	uint16_t region_map[SLOT_REGIONS][SLOT_REGIONS];	/* Bit (y%R)*R + x%R set if PE has free slots */
+	uint16_t region_free[SLOT_REGIONS][SLOT_REGIONS];
+} slot_index_t;
+
+/**
+ * @brief Initializes the index with every slot free
+ *
+ * @param idx Pointer to the index
+ * @param dim_x Mesh width
+ * @param dim_y Mesh height
+ * @param tasks_per_pe Number of task slots per PE
+ *
+ * @return
+ *  0 success
+ * -EINVAL mesh larger than SLOT_MAX_DIM or invalid tasks_per_pe
+ */
+int slot_init(slot_index_t *idx, int dim_x, int dim_y, int tasks_per_pe);
+
+/**
+ * @brief Occupies a slot of a PE
+ *
+ * @param idx Pointer to the index
+ * @param addr Address of the PE
+ *
+ * @return
+ *  0 success
+ * -EINVAL address outside the mesh
+ * -EBUSY no free slot in the PE
+ */
+int slot_take(slot_index_t *idx, int addr);
+
+/**
+ * @brief Frees a slot of a PE (TASK_TERMINATED, source of TASK_MIGRATED)
+ *
+ * @param idx Pointer to the index
+ * @param addr Address of the PE
+ *
+ * @return
+ *  0 success
+ * -EINVAL address outside the mesh
+ */
+int slot_release(slot_index_t *idx, int addr);
+
+/**
+ * @brief Finds the PE with free slots nearest to an address
+ *
+ * @param idx Pointer to the index
+ * @param addr Address to search from
+ *
+ * @return Address of the PE, -1 if the mesh is full, -EINVAL if addr is
+ * outside the mesh
+ */
+int slot_nearest(slot_index_t *idx, int addr);
+
+/**
+ * @brief Gets the number of free slots in a PE
+ *
+ * @param idx Pointer to the index
+ * @param addr Address of the PE
+ * @return Number of free slots, -EINVAL if outside the mesh
+ */
+int slot_get_free(slot_index_t *idx, int addr);
@@ -21,6 +21,76 @@
 
 #define MAX_HOPS_SIZE 256
 
+#ifndef VOL_MON_WINDOW
+#define VOL_MON_WINDOW 0	/* Snapshot window in ticks. 0 disables snapshots */
+#endif
+
+/**
+ * @brief Closes every window that ended before now
+ * 
+ * @details Windows are aligned to multiples of VOL_MON_WINDOW from the monitor
+ * start. Consecutive windows without traffic are merged in a single gap mark.
+ * The monitor has no timer: windows are only closed when the next record
+ * arrives, so snapshots of a window are emitted late after idle periods.
+ * 
+ * @param flits_win Window histogram
+ * @param win_start Pointer to the start of the current window
+ * @param now Current tick
+ */
+void _vol_window(uint32_t *flits_win, unsigned *win_start, unsigned now);
+
+/**
+ * @brief Emits the window histogram and resets it
+ * 
+ * @details One CSV line per non-empty hop count: SNAP,<start>,<end>,<hops>,<flits>
+ * 
+ * @param flits_win Window histogram
+ * @param start Tick when the window started
+ * @param end Tick when the window ended
+ * 
+ * @return True if the window had traffic
+ */
+bool _vol_snapshot(uint32_t *flits_win, unsigned start, unsigned end);
+
+/**
+ * @brief Marks an interval without traffic
+ * 
+ * @details CSV line GAP,<start>,<end>
+ * 
+ * @param start Tick when the first empty window started
+ * @param end Tick when the last empty window ended
+ */
+void _vol_gap(unsigned start, unsigned end);
+
+/**
+ * @brief Joins the reduction tree of all volume observers
+ * 
+ * @details Observers are ordered by ID and the node at index i has its parent
+ * at (i - 1)/2, which always has a lower ID, so the tree has no cycles even
+ * if discoveries disagree. A node announces itself to its parent with
+ * VOL_AGGREGATE_JOIN and parents only wait for the children that joined.
+ * A node whose discovery fails does not join and prints its own result.
+ * 
+ * @param parent Pointer to store the parent ID (-1 if root)
+ * 
+ * @return
+ *  0 success
+ *  1 request to terminate the app
+ * <0 discovery failed (runs as a standalone root)
+ */
+int _vol_tree_init(int *parent);
+
+/**
+ * @brief Sends the histogram as a partial result to the parent observer
+ * 
+ * @details Non-empty buckets are packed VOL_AGGREGATE_MAX per message, which
+ * is a single message for any mesh up to 8x8
+ * 
+ * @param flits_hop Histogram to send
+ * @param parent ID of the parent observer
+ */
+void _vol_forward(uint32_t *flits_hop, int parent);
+
 int main()
 {
 	printf("Volume monitor started at %d\n", memphis_get_tick());
@@ -28,40 +98,200 @@ int main()
 	static oda_t observer;
 	oda_init(&observer);
 
-	int ret = memphis_mkfifo(sizeof(memphis_vol_monitor_t), 64);
+	int ret = memphis_mkfifo(sizeof(memphis_vol_aggregate_t), 64);
 	if (ret != 0)
 		return ret;
 
+	int parent = -1;
+	int children = 0;	/* Joined children still to send their partial result */
+	ret = _vol_tree_init(&parent);
+	if (ret == 1)
+		return 0;
+
+	if (ret < 0)
+		printf("(VOL_MON) Discovery failed (%d), not aggregating\n", ret);
+
 	mon_announce(MON_VOL);
 
-	uint16_t flits_hop[MAX_HOPS_SIZE];
+	static uint32_t flits_hop[MAX_HOPS_SIZE];
+	static uint32_t flits_win[MAX_HOPS_SIZE];
 	for (uint16_t array_index = 0; array_index < MAX_HOPS_SIZE; array_index++)
 	{
 		flits_hop[array_index] = 0;
+		flits_win[array_index] = 0;
 	}
 
+	unsigned win_start = memphis_get_tick();
+
+	unsigned records = 0;
+	bool terminating = false;
 	while (true) {
-		static memphis_vol_monitor_t message;
-		memphis_receive_any(&message, sizeof(memphis_vol_monitor_t));
-		switch (message.service) {
+		static union {
+			memphis_vol_monitor_t   monitor;
+			memphis_vol_aggregate_t aggregate;
+		} record;
+		memphis_receive_any(&record, sizeof(record));
+
+		unsigned now = memphis_get_tick();
+		if (VOL_MON_WINDOW != 0)
+			_vol_window(flits_win, &win_start, now);
+
+		switch (record.monitor.service) {
 			case VOL_MONITOR:
-				flits_hop[message.hops] += message.size;
+				flits_hop[record.monitor.hops] += record.monitor.size;
+				flits_win[record.monitor.hops] += record.monitor.size;
+				records++;
+				break;
+			case VOL_AGGREGATE_JOIN:
+				children++;
+				break;
+			case VOL_AGGREGATE:
+				for (int i = 0; i < record.aggregate.cnt && i < VOL_AGGREGATE_MAX; i++) {
+					memphis_vol_bucket_t *bucket = &record.aggregate.buckets[i];
+					flits_hop[bucket->hops] += bucket->flits;
+				}
+				if (record.aggregate.last)
+					children--;
 				break;
 			case TERMINATE_ODA:
-				printf("(VOL_MON) Flits transit:\n");
+				/* Last window is partial */
+				if (VOL_MON_WINDOW != 0 && !_vol_snapshot(flits_win, win_start, now) && now != win_start)
+					_vol_gap(win_start, now);
 
-				for (uint16_t hops_index = 0; hops_index < MAX_HOPS_SIZE; hops_index++)
-				{
-					if (flits_hop[hops_index] > 0)
-					{
-						printf("(VOL_MON) 	Hops[%u]=%u\n", hops_index, flits_hop[hops_index]);
-					}
-				}
-				return 0;
+				printf("(VOL_MON) Terminated at %u: records=%u\n", now, records);
+				terminating = true;
+				break;
 			default:
 				break;
 		}
+
+		/* Wait for the partial results of the whole subtree */
+		if (terminating && children <= 0) {
+			if (parent != -1) {
+				_vol_forward(flits_hop, parent);
+				return 0;
+			}
+
+			printf("(VOL_MON) Flits transit:\n");
+
+			for (uint16_t hops_index = 0; hops_index < MAX_HOPS_SIZE; hops_index++)
+			{
+				if (flits_hop[hops_index] > 0)
+				{
+					printf("(VOL_MON) 	Hops[%u]=%u\n", hops_index, (unsigned)flits_hop[hops_index]);
+				}
+			}
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+void _vol_window(uint32_t *flits_win, unsigned *win_start, unsigned now)
+{
+	const unsigned elapsed = (now - *win_start) / VOL_MON_WINDOW;
+	if (elapsed == 0)
+		return;
+
+	unsigned gap_start = *win_start + VOL_MON_WINDOW;
+	if (!_vol_snapshot(flits_win, *win_start, gap_start))
+		gap_start = *win_start;
+
+	const unsigned gap_end = *win_start + elapsed * VOL_MON_WINDOW;
+	if (gap_end != gap_start)
+		_vol_gap(gap_start, gap_end);
+
+	*win_start = gap_end;
+}
+
+bool _vol_snapshot(uint32_t *flits_win, unsigned start, unsigned end)
+{
+	bool traffic = false;
+	for (uint16_t hops_index = 0; hops_index < MAX_HOPS_SIZE; hops_index++) {
+		if (flits_win[hops_index] > 0) {
+			printf("(VOL_MON) SNAP,%u,%u,%u,%u\n", start, end, hops_index, (unsigned)flits_win[hops_index]);
+			flits_win[hops_index] = 0;
+			traffic = true;
+		}
+	}
+
+	return traffic;
+}
+
+void _vol_gap(unsigned start, unsigned end)
+{
+	printf("(VOL_MON) GAP,%u,%u\n", start, end);
+}
+
+int _vol_tree_init(int *parent)
+{
+	static oda_list_t peers;
+	oda_list_init(&peers);
+
+	int ret = oda_request_all_services(&peers, ODA_OBSERVE | O_VOL);
+	if (ret != 0)
+		return ret;
+
+	int id = memphis_get_id();
+
+	/* Sort IDs so parents always have lower IDs than their children */
+	for (int i = 1; i < peers.cnt; i++) {
+		int key = peers.ids[i];
+		int j = i - 1;
+		while (j >= 0 && peers.ids[j] > key) {
+			peers.ids[j + 1] = peers.ids[j];
+			j--;
+		}
+		peers.ids[j + 1] = key;
+	}
+
+	int index = -1;
+	for (int i = 0; i < peers.cnt; i++) {
+		if (peers.ids[i] == id)
+			index = i;
+	}
+
+	if (index > 0)
+		*parent = peers.ids[(index - 1)/2];
+
+	free(peers.ids);
+
+	if (*parent != -1) {
+		static memphis_vol_monitor_t join;
+		join.service = VOL_AGGREGATE_JOIN;
+		memphis_send_any(&join, sizeof(memphis_vol_monitor_t), *parent);
 	}
 
 	return 0;
 }
+
+void _vol_forward(uint32_t *flits_hop, int parent)
+{
+	static memphis_vol_aggregate_t aggregate;
+	aggregate.service = VOL_AGGREGATE;
+	aggregate.cnt     = 0;
+
+	for (uint16_t hops_index = 0; hops_index < MAX_HOPS_SIZE; hops_index++) {
+		if (flits_hop[hops_index] == 0)
+			continue;
+
+		if (aggregate.cnt == VOL_AGGREGATE_MAX) {
+			aggregate.last = false;
+			memphis_send_any(&aggregate, sizeof(memphis_vol_aggregate_t), parent);
+			aggregate.cnt = 0;
+		}
+
+		aggregate.buckets[aggregate.cnt].hops  = hops_index;
+		aggregate.buckets[aggregate.cnt].flits = flits_hop[hops_index];
+		aggregate.cnt++;
+	}
+
+	/* The last message closes the partial result, even if empty */
+	aggregate.last = true;
+	memphis_send_any(
+		&aggregate, 
+		sizeof(memphis_vol_aggregate_t) - (VOL_AGGREGATE_MAX - aggregate.cnt) * sizeof(memphis_vol_bucket_t), 
+		parent
+	);
+}
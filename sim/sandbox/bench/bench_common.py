@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+import glob
+import os
+import re
+import shlex
+import subprocess
+
+from yaml import safe_load, safe_dump
+
+SANDBOX = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+MEMPHIS = os.path.join(os.path.dirname(os.path.dirname(SANDBOX)), "Memphis-V")
+
+# Command used to simulate a testcase/scenario pair
+RUNNER = "memphis-run {testcase} {scenario} {timeout}"
+
+# Log files produced by a simulation, relative to the directory of the run
+LOGS = "**/log*.txt"
+
+def load_yaml(path):
+	with open(path, "r") as f:
+		return safe_load(f)
+
+def dump_yaml(path, data):
+	with open(path, "w") as f:
+		safe_dump(data, f, sort_keys=False)
+
+def run(testcase, scenario, timeout, runner=RUNNER, logs=LOGS, env=None):
+	"""
+	Simulates a scenario and returns everything it printed, including the
+	PE logs found next to the testcase after the run. Variables in env are
+	added to the environment of the runner, and so of the builds it starts.
+	"""
+	testcase = os.path.abspath(testcase)
+	scenario = os.path.abspath(scenario)
+
+	cmd = runner.format(testcase=testcase, scenario=scenario, timeout=timeout)
+	workdir = os.path.dirname(testcase)
+
+	run_env = None
+	if env is not None:
+		run_env = dict(os.environ)
+		run_env.update(env)
+
+	proc = subprocess.run(shlex.split(cmd), cwd=workdir, env=run_env, capture_output=True, text=True)
+	if proc.returncode != 0:
+		print("Run '{}' failed with code {}".format(cmd, proc.returncode))
+
+	out = proc.stdout
+	for log in sorted(glob.glob(os.path.join(workdir, logs), recursive=True)):
+		with open(log, "r", errors="replace") as f:
+			out += f.read()
+
+	return out
+
+def parse_vol(out):
+	"""
+	Returns the flits per hop count reported by vol_monitor
+	"""
+	hops = {}
+	for m in re.finditer(r"\(VOL_MON\)\s+Hops\[(\d+)\]=(\d+)", out):
+		hops[int(m.group(1))] = hops.get(int(m.group(1)), 0) + int(m.group(2))
+
+	return hops
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+Scaling benchmark matrix.
+
+Generates testcase variants of my_testcase.yaml over mesh size, tasks per PE
+and page size, simulates a scenario on each one and writes a JSON report with
+one entry per variant. With --baseline, every metric is compared to the entry
+of the same variant in a previous report and the script exits with 1 when a
+metric got worse by more than --tolerance.
+"""
+
+import argparse
+import copy
+import json
+import os
+import re
+import sys
+
+import bench_common as bench
+
+# Metric: (regex, reduction over all matches of the first group, True if lower is better)
+# Every vol_monitor logs the tick and its record count when it receives
+# TERMINATE_ODA at the end of the scenario
+METRICS = {
+	"scenario_end":    (r"\(VOL_MON\) Terminated at (\d+):", max, True),
+	"monitor_records": (r"\(VOL_MON\) Terminated at \d+: records=(\d+)", sum, True),
+}
+
+# Metric: (function of the flits per hop count reported by vol_monitor, True if lower is better)
+VOL_METRICS = {
+	"noc_flits": (lambda hops: sum(hops.values()), True),
+	"flit_hops": (lambda hops: sum(h*f for h, f in hops.items()), True),
+}
+
+LOWER_BETTER = {name: metric[-1] for name, metric in list(METRICS.items()) + list(VOL_METRICS.items())}
+
+def make_testcase(base, dim, tasks_per_pe, page_kb):
+	tc = copy.deepcopy(base)
+	hw = tc["hw"]
+	hw["mpsoc_dimension"]   = [dim, dim]
+	hw["tasks_per_PE"]      = tasks_per_pe
+	hw["page_size_inst_KB"] = page_kb
+	hw["page_size_data_KB"] = page_kb
+
+	# Keep APP_INJ at the north-east corner
+	for periph in hw.get("Peripherals", []):
+		if periph["name"] == "APP_INJ":
+			periph["pe"] = "{},{}".format(dim - 1, dim - 1)
+
+	return tc
+
+def measure(out):
+	res = {}
+	for name, (regex, reduce, _) in METRICS.items():
+		values = [m.group(1) for m in re.finditer(regex, out)]
+		if len(values) > 0:
+			res[name] = reduce(int(v) for v in values)
+		else:
+			res[name] = None
+
+	hops = bench.parse_vol(out)
+	for name, (func, _) in VOL_METRICS.items():
+		res[name] = func(hops) if len(hops) > 0 else None
+
+	return res
+
+def compare(report, baseline, tolerance):
+	prev = {(r["dim"], r["tasks_per_PE"], r["page_KB"]): r for r in baseline["runs"]}
+
+	regressions = []
+	for run in report["runs"]:
+		key = (run["dim"], run["tasks_per_PE"], run["page_KB"])
+		if key not in prev:
+			continue
+
+		for name, lower in LOWER_BETTER.items():
+			now, old = run["metrics"].get(name), prev[key]["metrics"].get(name)
+			if now is None or old is None:
+				regressions.append("{}x{} tpp={} page={}KB {}: missing ({} -> {})".format(
+					key[0], key[0], key[1], key[2], name, old, now
+				))
+				continue
+
+			if old == 0:
+				delta = 0.0 if now == 0 else float("inf")
+			else:
+				delta = (now - old)/old
+
+			run.setdefault("delta", {})[name] = delta
+			if (delta > tolerance) if lower else (delta < -tolerance):
+				regressions.append("{}x{} tpp={} page={}KB {}: {} -> {} ({:+.1%})".format(
+					key[0], key[0], key[1], key[2], name, old, now, delta
+				))
+
+	return regressions
+
+def main():
+	parser = argparse.ArgumentParser(description="Scaling benchmark matrix")
+	parser.add_argument("--testcase", default=os.path.join(bench.SANDBOX, "my_testcase.yaml"))
+	parser.add_argument("--scenario", default=os.path.join(bench.SANDBOX, "my_scenario.yaml"))
+	parser.add_argument("--dims", nargs="+", type=int, default=[3, 4, 6, 8, 12, 16])
+	parser.add_argument("--tasks-per-pe", nargs="+", type=int, default=[1, 2, 4, 8])
+	parser.add_argument("--pages", nargs="+", type=int, default=[16, 32, 64])
+	parser.add_argument("--timeout", type=int, default=100)
+	parser.add_argument("--runner", default=bench.RUNNER)
+	parser.add_argument("--logs", default=bench.LOGS)
+	parser.add_argument("--workdir", default="scaling")
+	parser.add_argument("--out", default="scaling.json")
+	parser.add_argument("--baseline", help="Previous report to compare against")
+	parser.add_argument("--tolerance", type=float, default=0.05)
+	args = parser.parse_args()
+
+	base = bench.load_yaml(args.testcase)
+	report = {"scenario": os.path.basename(args.scenario), "runs": []}
+
+	for dim in args.dims:
+		for tpp in args.tasks_per_pe:
+			for page in args.pages:
+				name = "tc_{0}x{0}_t{1}_p{2}".format(dim, tpp, page)
+				rundir = os.path.join(args.workdir, name)
+				os.makedirs(rundir, exist_ok=True)
+
+				tc = make_testcase(base, dim, tpp, page)
+				testcase = os.path.join(rundir, name + ".yaml")
+				bench.dump_yaml(testcase, tc)
+
+				out = bench.run(testcase, os.path.abspath(args.scenario), args.timeout, args.runner, args.logs)
+				metrics = measure(out)
+				print(name, metrics)
+
+				report["runs"].append({"dim": dim, "tasks_per_PE": tpp, "page_KB": page, "metrics": metrics})
+
+	regressions = []
+	if args.baseline is not None:
+		with open(args.baseline, "r") as f:
+			regressions = compare(report, json.load(f), args.tolerance)
+		report["regressions"] = regressions
+
+	with open(args.out, "w") as f:
+		json.dump(report, f, indent=2)
+
+	for reg in regressions:
+		print("REGRESSION", reg)
+
+	sys.exit(1 if len(regressions) > 0 else 0)
+
+if __name__ == "__main__":
+	main()
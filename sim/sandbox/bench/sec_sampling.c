@@ -0,0 +1,162 @@
+/**
+ * MA-Memphis
+ * @file sec_sampling.c
+ *
+ * @date October 2026
+ *
+ * @brief Host check of the sampled SEC monitoring against full-rate monitoring
+ *
+ * @details Links the kernel llm.c with the stub headers in stubs/ and builds
+ * once per sampling mode, from this directory:
+ * for m in 0 1 2; do
+ *   cc -O2 -DMON_SEC_SAMPLING=$m -Istubs -I../../../Memphis-V/MAestro/src/include \
+ *      -I../../../Memphis-V/libmemphis/src/include sec_sampling.c \
+ *      ../../../Memphis-V/MAestro/src/llm.c ../../../Memphis-V/libmemphis/src/sec_estimate.c \
+ *      -o sec_sampling && ./sec_sampling
+ * done
+ *
+ * Every case feeds messages to llm_sec and estimates the traffic of each flow
+ * from the records written to the observer. Prints CSV:
+ * mode,case,flow,messages,est_messages,latency,est_latency,records
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <mmr.h>
+#include <mpipe.h>
+#include <llm.h>
+
+#include <memphis/monitor.h>
+#include <memphis/services.h>
+#include <memphis/sec_estimate.h>
+
+#define FLOWS 2
+
+unsigned MMR_DMNI_INF_ADDRESS = 0x0202;
+unsigned MMR_RTC_MTIME        = 0;
+
+static int _prod[FLOWS];
+static int _cons[FLOWS];
+
+static sec_estimate_t _est[FLOWS];
+static unsigned _records;
+
+static unsigned long _msgs[FLOWS];
+static unsigned long _lat[FLOWS];
+
+int mpipe_write(void *buf, size_t size, int addr)
+{
+	memphis_sec_monitor_t *monitor = buf;
+	if (monitor->service != SEC_MONITOR)
+		return 0;
+
+	_records++;
+
+	for (int f = 0; f < FLOWS; f++) {
+		if (monitor->prod == (_prod[f] & 0xFF) && monitor->cons == (_cons[f] & 0xFF) && monitor->app == ((_prod[f] >> 8) & 0xFF))
+			sec_estimate_add(&_est[f], monitor);
+	}
+
+	return 0;
+}
+
+void slack_update(int id, unsigned slack_time, unsigned remaining_exec_time)
+{
+}
+
+/**
+ * @brief Flow table slot of a flow, as hashed by llm.c
+ */
+static unsigned _slot(int prod, int cons)
+{
+	const unsigned p = prod & 0xFFFF;
+	const unsigned c = cons & 0xFFFF;
+	return (p ^ (c << 2) ^ (c >> 8)) % 16;
+}
+
+static void _reset(int prod0, int cons0, int prod1, int cons1)
+{
+	llm_init();
+	llm_set_observer(MON_SEC, 0x0001, 0x0001);
+
+	_prod[0] = prod0;
+	_cons[0] = cons0;
+	_prod[1] = prod1;
+	_cons[1] = cons1;
+
+	_records = 0;
+	for (int f = 0; f < FLOWS; f++) {
+		sec_estimate_init(&_est[f]);
+		_msgs[f] = 0;
+		_lat[f]  = 0;
+	}
+}
+
+static void _message(int f, unsigned latency)
+{
+	MMR_RTC_MTIME += 100;
+	llm_sec(MMR_RTC_MTIME - latency, 10, 0x0101, MMR_DMNI_INF_ADDRESS, _prod[f], _cons[f], MMR_RTC_MTIME);
+	_msgs[f]++;
+	_lat[f] += latency;
+}
+
+static void _report(const char *name, int flows)
+{
+	for (int f = 0; f < flows; f++) {
+		printf(
+			"%d,%s,%d,%lu,%u,%lu,%u,%u\n",
+			MON_SEC_SAMPLING,
+			name,
+			f,
+			_msgs[f],
+			sec_estimate_messages(&_est[f]),
+			_lat[f] / _msgs[f],
+			sec_estimate_latency(&_est[f]),
+			_records
+		);
+	}
+}
+
+int main()
+{
+	unsigned last_monitored = 0;
+
+	/* A short flow that stops: its run is sent by the age bound */
+	_reset(0x0105, 0x0106, 0, 0);
+	for (int i = 0; i < 10; i++)
+		_message(0, 100);
+	MMR_RTC_MTIME += MON_SEC_MAX_AGE;
+	llm_rt(&last_monitored, 0x0106, 0, 0);
+	_report("stopped", 1);
+
+	/* A spike every 50th message, then the consumer terminates */
+	_reset(0x0105, 0x0106, 0, 0);
+	for (int i = 0; i < 2000; i++)
+		_message(0, (i % 50 == 49) ? 1000 : 100);
+	llm_sec_flush(0x0106);
+	_report("spikes", 1);
+
+	/* Bursts of two flows evicting each other from the same slot */
+	int prod = 0x0106;
+	while (_slot(prod, prod + 7) != _slot(0x0105, 0x0106))
+		prod++;
+	_reset(0x0105, 0x0106, prod, prod + 7);
+	for (int i = 0; i < 2000; i++) {
+		const int f = (i % 40 < 30) ? 0 : 1;
+		_message(f, (_msgs[f] % 50 == 49) ? 1000 : 100);
+	}
+	llm_sec_flush(_cons[0]);
+	llm_sec_flush(_cons[1]);
+	_report("collision", 2);
+
+	/* IDs with the sign bit set keep their flow state */
+	_reset(0xFF01, 0xFF02, 0, 0);
+	for (int i = 0; i < 1000; i++)
+		_message(0, 100);
+	llm_sec_flush(0xFF02);
+	_report("kernel_ids", 1);
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * MA-Memphis
+ * @file slot_bench.c
+ *
+ * @date October 2026
+ *
+ * @brief Host benchmark of the mapper free-slot index against a full mesh scan
+ *
+ * @details Build and run from this directory:
+ * cc -O2 -I../../../Memphis-V/management/mapper_task/src slot_bench.c \
+ *    ../../../Memphis-V/management/mapper_task/src/slot_index.c -o slot_bench && ./slot_bench
+ *
+ * For each mesh size, maps tasks next to random points until the mesh is at
+ * the target occupancy and keeps it there by terminating random tasks.
+ * Prints CSV: dim,occupancy,placements,index_ns,scan_ns
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "slot_index.h"
+
+#define PLACEMENTS    200000
+#define TASKS_PER_PE  2
+
+static int _tasks[SLOT_MAX_DIM*SLOT_MAX_DIM*TASKS_PER_PE];
+
+/**
+ * @brief Reference search: scans the whole mesh
+ */
+static int _scan_nearest(slot_index_t *idx, int addr)
+{
+	const int x = addr >> 8;
+	const int y = addr & 0xFF;
+
+	int best = -1;
+	int best_dist = idx->dim_x + idx->dim_y;
+	for (int px = 0; px < idx->dim_x; px++) {
+		for (int py = 0; py < idx->dim_y; py++) {
+			const int dist = abs(px - x) + abs(py - y);
+			if (idx->pe_free[px][py] > 0 && dist < best_dist) {
+				best_dist = dist;
+				best = (px << 8) | py;
+			}
+		}
+	}
+
+	return best;
+}
+
+static int _dist(int a, int b)
+{
+	return abs((a >> 8) - (b >> 8)) + abs((a & 0xFF) - (b & 0xFF));
+}
+
+static double _run(int dim, double occupancy, bool use_index, bool check)
+{
+	static slot_index_t idx;
+	if (slot_init(&idx, dim, dim, TASKS_PER_PE) != 0) {
+		printf("Mesh %dx%d not supported\n", dim, dim);
+		exit(1);
+	}
+
+	const int target = dim * dim * TASKS_PER_PE * occupancy;
+	int mapped = 0;
+
+	srand(dim);
+	clock_t start = clock();
+
+	for (int i = 0; i < PLACEMENTS; i++) {
+		if (mapped == target) {
+			/* TASK_TERMINATED of a random task */
+			int victim = rand() % mapped;
+			slot_release(&idx, _tasks[victim]);
+			_tasks[victim] = _tasks[--mapped];
+		}
+
+		const int from = ((rand() % dim) << 8) | (rand() % dim);
+		const int pe = use_index ? slot_nearest(&idx, from) : _scan_nearest(&idx, from);
+
+		if (check && _dist(from, pe) != _dist(from, _scan_nearest(&idx, from))) {
+			printf("Mismatch at %dx%d from %x: %x\n", dim, dim, from, pe);
+			exit(1);
+		}
+
+		slot_take(&idx, pe);
+		_tasks[mapped++] = pe;
+	}
+
+	return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / PLACEMENTS;
+}
+
+int main()
+{
+	const double occupancies[] = {0.5, 0.9};
+
+	printf("dim,occupancy,placements,index_ns,scan_ns\n");
+	for (int dim = 4; dim <= SLOT_MAX_DIM; dim += 2) {
+		for (int o = 0; o < 2; o++) {
+			_run(dim, occupancies[o], true, true);
+
+			double index_ns = _run(dim, occupancies[o], true, false);
+			double scan_ns  = _run(dim, occupancies[o], false, false);
+			printf("%d,%.2f,%d,%.1f,%.1f\n", dim, occupancies[o], PLACEMENTS, index_ns, scan_ns);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+/* Host stand-ins for the memory-mapped registers used by llm.c */
+extern unsigned MMR_DMNI_INF_ADDRESS;
+extern unsigned MMR_RTC_MTIME;
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <stddef.h>
+
+int mpipe_write(void *buf, size_t size, int addr);
@@ -0,0 +1,3 @@
+#pragma once
+
+void slack_update(int id, unsigned slack_time, unsigned remaining_exec_time);
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""
+Load-latency sweep of the synth application.
+
+Generates one synth injector and one synth sink for every PE of the testcase
+mesh that holds no management task, statically mapped on that PE. For every
+traffic pattern and injection period, builds synth with the parameters as -D
+flags in CFLAGS (overriding the synth_cfg.h defaults) in a fresh per-point
+workdir, simulates bench/synth_scenario.yaml with the synth mapping and
+reports the offered load, the accepted throughput and the message latency as
+CSV:
+pattern,period,offered,accepted,lat_avg,lat_max,vol_flits,vol_avg_hops
+
+Loads are in flits per tick for the whole application. Latencies are measured
+by the sinks from the scheduled injection tick carried in each message.
+"""
+
+import argparse
+import copy
+import glob
+import os
+import re
+import shutil
+import sys
+
+import bench_common as bench
+
+PATTERNS = ["uniform", "transpose", "bitcomp", "hotspot", "neighbor"]
+
+SYNTH_SRC = os.path.join(bench.MEMPHIS, "applications", "synth", "src")
+
+def participants(testcase, scenario):
+	"""
+	Returns the mesh dimensions and the PEs free of management tasks
+	"""
+	dim_x, dim_y = testcase["hw"]["mpsoc_dimension"]
+
+	busy = set()
+	for task in scenario.get("management", []):
+		if "static_mapping" in task:
+			busy.add(tuple(task["static_mapping"]))
+
+	pes = [(x, y) for x in range(dim_x) for y in range(dim_y) if (x, y) not in busy]
+
+	return dim_x, dim_y, pes
+
+def generate(dim_x, dim_y, pes):
+	"""
+	Writes synth_map.h and the synth tasks for a list of PEs.
+	Returns the static mapping of the tasks.
+	"""
+	for old in glob.glob(os.path.join(SYNTH_SRC, "synth_gen_*.c")):
+		os.remove(old)
+
+	with open(os.path.join(SYNTH_SRC, "synth_map.h"), "w") as f:
+		f.write("/* Generated by sim/sandbox/bench/synth_sweep.py */\n\n")
+		f.write("#pragma once\n\n")
+		f.write("#define SYNTH_DIM_X {}\n".format(dim_x))
+		f.write("#define SYNTH_DIM_Y {}\n".format(dim_y))
+		f.write("#define SYNTH_PES   {}\n\n".format(len(pes)))
+		f.write("static const int _synth_pes[SYNTH_PES] = {{{}}};\n".format(
+			", ".join("0x{:02X}{:02X}".format(x, y) for x, y in pes)
+		))
+
+	mapping = {}
+	for idx, (x, y) in enumerate(pes):
+		for role, run in (("inj", "synth_inject"), ("sink", "synth_sink")):
+			name = "synth_gen_{}_{:03d}".format(role, idx)
+			with open(os.path.join(SYNTH_SRC, name + ".c"), "w") as f:
+				f.write("#include \"synth.h\"\n\n")
+				f.write("int main()\n{{\n\treturn {}({});\n}}\n".format(run, idx))
+
+			mapping[name] = [x, y]
+
+	return mapping
+
+def cfg_env(pattern, size, period, rounds):
+	"""
+	Returns the environment that builds synth with the given parameters
+	"""
+	flags = [
+		"-DSYNTH_PATTERN=SYNTH_{}".format(pattern.upper()),
+		"-DSYNTH_MSG_SIZE={}".format(size),
+		"-DSYNTH_PERIOD={}".format(period),
+		"-DSYNTH_ROUNDS={}".format(rounds)
+	]
+
+	return {"CFLAGS": " ".join([os.environ.get("CFLAGS", "")] + flags).strip()}
+
+def parse_synth(out):
+	inj = []
+	for m in re.finditer(r"SYNTH_INJ,(\d+(?:,\d+){6})", out):
+		v = [int(x) for x in m.group(1).split(",")]
+		inj.append({"idx": v[1], "size": v[2], "period": v[3], "sent": v[4], "start": v[5], "end": v[6]})
+
+	sink = []
+	for m in re.finditer(r"SYNTH_SINK,(\d+(?:,\d+){7})", out):
+		v = [int(x) for x in m.group(1).split(",")]
+		sink.append({
+			"idx": v[1], "size": v[2], "recv": v[3], "lat_avg": v[4], "lat_max": v[5],
+			"start": v[6], "end": v[7]
+		})
+
+	return inj, sink
+
+def summarize(inj, sink, rounds, hops):
+	if len(inj) == 0 or len(sink) == 0:
+		return None
+
+	size     = inj[0]["size"]
+	period   = inj[0]["period"]
+	sent     = sum(t["sent"] for t in inj)
+	recv     = sum(t["recv"] for t in sink)
+	duration = max(t["end"] for t in sink) - min(t["start"] for t in inj)
+
+	vol_flits = sum(hops.values())
+	vol_hops  = sum(h*f for h, f in hops.items())
+
+	return {
+		"offered":      sent*size/(rounds*period) if period > 0 else float("inf"),
+		"accepted":     recv*size/duration if duration > 0 else 0.0,
+		"lat_avg":      sum(t["lat_avg"]*t["recv"] for t in sink)/recv if recv > 0 else 0.0,
+		"lat_max":      max(t["lat_max"] for t in sink),
+		"vol_flits":    vol_flits,
+		"vol_avg_hops": vol_hops/vol_flits if vol_flits > 0 else 0.0
+	}
+
+def main():
+	parser = argparse.ArgumentParser(description="Synthetic traffic load-latency sweep")
+	parser.add_argument("--testcase", default=os.path.join(bench.SANDBOX, "my_testcase.yaml"))
+	parser.add_argument("--patterns", nargs="+", default=PATTERNS, choices=PATTERNS)
+	parser.add_argument("--periods", nargs="+", type=int, default=[20000, 10000, 5000, 2000, 1000, 500, 200, 0])
+	parser.add_argument("--size", type=int, default=64, help="Message size in 32-bit words, at least 2")
+	parser.add_argument("--rounds", type=int, default=100)
+	parser.add_argument("--timeout", type=int, default=100)
+	parser.add_argument("--runner", default=bench.RUNNER)
+	parser.add_argument("--logs", default=bench.LOGS)
+	parser.add_argument("--workdir", default="synth_sweep")
+	parser.add_argument("--out", default="synth_sweep.csv")
+	args = parser.parse_args()
+
+	if args.size < 2:
+		parser.error("--size must be at least 2: messages carry the injection tick and the round")
+
+	tc = bench.load_yaml(args.testcase)
+	if tc["hw"]["tasks_per_PE"] < 2:
+		parser.error("the testcase needs tasks_per_PE >= 2 to host an injector and a sink per PE")
+
+	base = bench.load_yaml(os.path.join(os.path.dirname(os.path.abspath(__file__)), "synth_scenario.yaml"))
+	dim_x, dim_y, pes = participants(tc, base)
+	if len(pes) < 2:
+		sys.exit("The mesh has fewer than 2 PEs free of management tasks")
+
+	scenario = copy.deepcopy(base)
+	for app in scenario["apps"]:
+		if app["name"] == "synth":
+			app["static_mapping"] = generate(dim_x, dim_y, pes)
+
+	with open(args.out, "w") as csv:
+		csv.write("pattern,period,offered,accepted,lat_avg,lat_max,vol_flits,vol_avg_hops\n")
+
+		for pattern in args.patterns:
+			for period in args.periods:
+				# A fresh testcase directory per point, so the -D flags reach a clean build
+				name = "synth_{}_p{}".format(pattern, period)
+				rundir = os.path.join(args.workdir, name)
+				shutil.rmtree(rundir, ignore_errors=True)
+				os.makedirs(rundir, exist_ok=True)
+
+				testcase = os.path.join(rundir, name + ".yaml")
+				bench.dump_yaml(testcase, tc)
+				scenario_path = os.path.join(rundir, "synth_scenario.yaml")
+				bench.dump_yaml(scenario_path, scenario)
+
+				env = cfg_env(pattern, args.size, period, args.rounds)
+				out = bench.run(testcase, scenario_path, args.timeout, args.runner, args.logs, env)
+				inj, sinks = parse_synth(out)
+				res = summarize(inj, sinks, args.rounds, bench.parse_vol(out))
+				if res is None:
+					print("{} period {}: no SYNTH output".format(pattern, period))
+					continue
+
+				line = "{},{},{:.4f},{:.4f},{:.1f},{},{},{:.2f}".format(
+					pattern, period, res["offered"], res["accepted"], res["lat_avg"],
+					res["lat_max"], res["vol_flits"], res["vol_avg_hops"]
+				)
+				print(line)
+				csv.write(line + "\n")
+
+if __name__ == "__main__":
+	main()